@@ -161,6 +161,7 @@ RazzleGame::RazzleGame(const std::map<std::string,int>& paramsMap, std::random_d
     engine(rnd()),
     outcomeStorageProfit() {
         recomputePolicy();
+        setSamplingBias(1.0);
     }
 
 bool RazzleGame::shouldContinue(int step) const {
@@ -174,6 +175,18 @@ void RazzleGame::recomputePolicy() {
     solveOptimalStopping();
 }
 
+int RazzleGame::nextStep(int sum, int step) const {
+    bool advance = mapRollToYard(sum, step);
+    if (advance) step++;
+
+    // (recompute yardValue exactly as in buildTransitionMatrix)
+    if (sum <= params.at("yardsPerStep1P")) return std::max(step, 1);
+    else if (sum <= params.at("yardsPerStep2P")) return std::max(step, 2);
+    else if (sum <= params.at("yardsPerStep3P")) return std::max(step, 3);
+    else if (sum <= params.at("yardsPerStep4P")) return std::max(step, 4);
+    return 5;
+}
+
 int RazzleGame::runGame() {
     std::uniform_int_distribution<int> dist(1, 6);
     int rollsLeft = params.at("maxRolls");         // fixed rolls
@@ -186,21 +199,7 @@ int RazzleGame::runGame() {
         int sum = 0;
         for (int i = 0; i < params.at("numOfDiceP"); i++) sum += dist(engine);
 
-        bool advance = mapRollToYard(sum, step);
-        if (advance) {
-            step++;
-            paidOut = mapStepToPayout(step);
-        }
-
-        // (recompute yardValue exactly as in buildTransitionMatrix)
-        int newStep = step;
-        if (sum <= params.at("yardsPerStep1P")) newStep = std::max(step, 1);
-        else if (sum <= params.at("yardsPerStep2P")) newStep = std::max(step, 2);
-        else if (sum <= params.at("yardsPerStep3P")) newStep = std::max(step, 3);
-        else if (sum <= params.at("yardsPerStep4P")) newStep = std::max(step, 4);
-        else newStep = 5;
-
-        step = newStep;
+        step = nextStep(sum, step);
         paidOut = mapStepToPayout(step);
         // decide whether to roll again or if out of rolls
         if (!shouldContinue(step) || rollsLeft == 0) {
@@ -223,3 +222,48 @@ int RazzleGame::runGame() {
 const std::map<std::string,int>& RazzleGame::getParameters() const {
     return params;
 }
+
+void RazzleGame::setSamplingBias(double bias) {
+    for (int step = 0; step <= 5; step++) {
+        // q(sum) proportional to p(sum), boosted where the roll reaches the last step
+        std::vector<double> q;
+        for (int sum = minSum; sum <= maxSum; sum++) {
+            double w = sumProb.at(sum);
+            if (step < 5 && nextStep(sum, step) == 5) w *= bias;
+            q.push_back(w);
+        }
+        double total = std::accumulate(q.begin(), q.end(), 0.0);
+        proposalRatio[step].assign(q.size(), 0.0);
+        for (size_t i = 0; i < q.size(); i++) {
+            if (q[i] > 0) proposalRatio[step][i] = sumProb.at(minSum + static_cast<int>(i)) / (q[i] / total);
+        }
+        proposal[step] = std::discrete_distribution<int>(q.begin(), q.end());
+    }
+}
+
+WeightedOutcome RazzleGame::runGameWeighted() {
+    // same game loop as runGame, but the dice sum is drawn from the proposal
+    int rollsLeft = params.at("maxRolls");
+    int step = 0;
+    int paidIn = params.at("payIn");
+    int paidOut = 0;
+    double weight = 1.0;
+    while (rollsLeft > 0) {
+        rollsLeft--;
+
+        int idx = proposal[step](engine);
+        weight *= proposalRatio[step][idx];
+        int sum = minSum + idx;
+
+        step = nextStep(sum, step);
+        paidOut = mapStepToPayout(step);
+        if (!shouldContinue(step) || rollsLeft == 0) {
+            break;
+        }
+    }
+
+    if (rollsLeft == 0 && step < 5) {
+        paidOut = 0;
+    }
+    return {paidOut - paidIn, step, weight};
+}
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <array>
 #include <vector>
 #include <mutex>
 #include <random>
@@ -7,6 +8,13 @@
 #include <numeric>
 #include <tbb/concurrent_vector.h>
 
+// outcome of an importance-sampled game: profit, final step and likelihood ratio
+struct WeightedOutcome {
+    int profit;
+    int step;
+    double weight;
+};
+
 class RazzleGame {
 private:
     // learnable game paramters 
@@ -25,9 +33,14 @@ private:
 
     tbb::concurrent_vector<int> outcomeStorageProfit;
 
+    // importance-sampling proposal: per-step sum distribution boosting sums that reach step 5
+    std::array<std::discrete_distribution<int>, 6> proposal;
+    std::array<std::vector<double>, 6> proposalRatio;  // p(sum) / q(sum), indexed by sum - minSum
+
     bool mapRollToYard(int S, int current) const;
     int mapStepToPayout(int current) const;
     bool shouldContinue(int step) const;
+    int nextStep(int sum, int step) const;
 
     void computeSumDistribution();
     void buildTransitionMatrix();
@@ -40,6 +53,13 @@ public:
     // run a single game and return profit (paidOut - paidIn)
     int runGame();
 
+    // bias the dice-sum distribution toward sums that reach step 5 by the
+    // given factor (must be > 0; 1.0 = plain sampling)
+    void setSamplingBias(double bias);
+
+    // run a single game under the biased proposal; weight is the likelihood ratio
+    WeightedOutcome runGameWeighted();
+
     // access parameters
     const std::map<std::string, int>& getParameters() const;
 };
\ No newline at end of file
@@ -6,6 +6,20 @@
 #include <utility>
 #include <thread>
 #include <fstream>
+#include <limits>
+#include <algorithm>
+#include <sstream>
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/time.h>
 #include <tbb/tbb.h>
 #include <tbb/global_control.h>
 
@@ -104,28 +118,7 @@ void Simulation::run(size_t numOfRuns) {
             int di = deltas[rng() % deltas.size()];
             if (bestAvgProfit < targetProfit && keyi.rfind("payoutPerStep",0)==0) di = std::abs(di);
             else if (bestAvgProfit > targetProfit && keyi.rfind("payoutPerStep",0)==0) di = -std::abs(di);
-            int oldVal = cp[keyi];
-            int val = oldVal + di;
-            auto rg = bounds[keyi];
-            if (val < rg.first || val > rg.second) val = oldVal;
-            cp[keyi] = val;
-            // enforce monotonic yard thresholds
-            if (keyi.rfind("yardsPerStep", 0) == 0) {
-                if (!(cp["yardsPerStep1P"] < cp["yardsPerStep2P"] &&
-                      cp["yardsPerStep2P"] < cp["yardsPerStep3P"] &&
-                      cp["yardsPerStep3P"] < cp["yardsPerStep4P"])) {
-                    cp[keyi] = oldVal;
-                }
-            }
-            // enforce monotonic payout per step
-            if (keyi.rfind("payoutPerStep", 0) == 0) {
-                if (!(cp["payoutPerStep1P"] < cp["payoutPerStep2P"] &&
-                      cp["payoutPerStep2P"] < cp["payoutPerStep3P"] &&
-                      cp["payoutPerStep3P"] < cp["payoutPerStep4P"] &&
-                      cp["payoutPerStep4P"] < cp["payoutPerStep5P"])) {
-                    cp[keyi] = oldVal;
-                }
-            }
+            applyMove(cp, keyi, di);
             double theoEV = computeTheoreticalEV(cp);
             candidates[i] = {std::move(cp), theoEV,
                              profitWeight * std::pow(theoEV - targetProfit, 2)};
@@ -180,6 +173,432 @@ void Simulation::run(size_t numOfRuns) {
     params = bestParams;  // adopt optimized parameters
 
     auto [finalAvgProfit, finalWinRate] = evaluate(params);
+    reportFinalParams(finalAvgProfit, finalWinRate);
+}
+
+void Simulation::runSteepestDescent(size_t maxRestarts, unsigned seed) {
+    // throttle TBB to user-specified threads
+    tbb::global_control ctl(tbb::global_control::max_allowed_parallelism, static_cast<int>(threadCount));
+    // same objective as run(): squared distance of theoretical EV from target
+    const double targetProfit = -0.75;
+    const double profitWeight = 100.0;
+    const double profitTolerance = 1e-3;
+    auto lossOf = [&](double theoEV) { return profitWeight * std::pow(theoEV - targetProfit, 2); };
+
+    // enumerate the full neighborhood once: every key x every delta
+    std::vector<std::string> keys;
+    for (auto& kv : params) keys.push_back(kv.first);
+    const std::vector<int> deltas = {1, -1, 2, -2, 3, -3, 4, -4, 5, -5};
+    std::vector<std::pair<std::string,int>> moves;
+    for (const auto& k : keys) for (int d : deltas) moves.emplace_back(k, d);
+
+    // fixed seed so the descent and restart sequence repeat run to run
+    std::mt19937 rng(seed);
+    // perturbation strength when stuck: number of random valid moves applied
+    const int kickMoves = 3;
+    const int maxStepsPerDescent = 1000;
+
+    double currEV = computeTheoreticalEV(params);
+    double currLoss = lossOf(currEV);
+    auto bestParams = params;
+    double bestAvgProfit = currEV;
+    double bestLoss = currLoss;
+    size_t restarts = 0;
+    size_t totalSteps = 0;
+
+    while (true) {
+        // descend until no move in the neighborhood improves the loss
+        for (int step = 0; step < maxStepsPerDescent; ++step) {
+            std::vector<double> moveLoss(moves.size(), std::numeric_limits<double>::infinity());
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, moves.size()),
+                [&](const tbb::blocked_range<size_t>& r) {
+                    for (size_t i = r.begin(); i != r.end(); ++i) {
+                        auto cp = params;
+                        if (!applyMove(cp, moves[i].first, moves[i].second)) continue;
+                        moveLoss[i] = lossOf(computeTheoreticalEV(cp));
+                    }
+                });
+            // lowest index wins ties so the walk is deterministic
+            size_t bestIdx = std::min_element(moveLoss.begin(), moveLoss.end()) - moveLoss.begin();
+            if (!(moveLoss[bestIdx] < currLoss)) break;  // local optimum
+            applyMove(params, moves[bestIdx].first, moves[bestIdx].second);
+            currLoss = moveLoss[bestIdx];
+            ++totalSteps;
+        }
+        if (currLoss < bestLoss) {
+            bestLoss = currLoss;
+            bestParams = params;
+            bestAvgProfit = computeTheoreticalEV(params);
+        }
+        if (std::abs(bestAvgProfit - targetProfit) < profitTolerance) {
+            std::cout << "Early stopping: avgProfit within tolerance of target." << std::endl;
+            break;
+        }
+        if (restarts >= maxRestarts) break;
+        // perturbation restart from the best optimum found so far
+        params = bestParams;
+        for (int k = 0; k < kickMoves; ++k) {
+            const auto& mv = moves[rng() % moves.size()];
+            applyMove(params, mv.first, mv.second);
+        }
+        currLoss = lossOf(computeTheoreticalEV(params));
+        ++restarts;
+    }
+    std::cout << "Steepest descent: " << totalSteps << " steps, "
+              << restarts << " restarts, bestLoss=" << bestLoss << std::endl;
+    params = bestParams;  // adopt optimized parameters
+
+    reportFinalParams(bestAvgProfit, 0.0);
+}
+
+bool Simulation::estimateTailRisk(size_t numGames, double bias) {
+    if (!(std::isfinite(bias) && bias > 0)) {
+        std::cerr << "Error: importance-sampling bias must be finite and positive, got " << bias << std::endl;
+        return false;
+    }
+    // throttle TBB to user-specified threads
+    tbb::global_control ctl(tbb::global_control::max_allowed_parallelism, static_cast<int>(threadCount));
+    // one game object per chunk: RazzleGame's engine is not thread-safe
+    const size_t chunks = std::max<size_t>(1, threadCount);
+    std::vector<RazzleGame> games;
+    games.reserve(chunks);
+    for (size_t c = 0; c < chunks; ++c) {
+        games.emplace_back(params, rd);
+        games.back().setSamplingBias(bias);
+    }
+    // weighted accumulators per chunk, merged after the parallel pass
+    struct Acc { double sumW = 0, sumW2 = 0, sumWJack = 0, sumWJack2 = 0, sumWProfit = 0; size_t jackHits = 0; };
+    std::vector<Acc> accs(chunks);
+    tbb::parallel_for(size_t(0), chunks, [&](size_t c) {
+        size_t begin = numGames * c / chunks, end = numGames * (c + 1) / chunks;
+        Acc& a = accs[c];
+        for (size_t i = begin; i < end; ++i) {
+            WeightedOutcome o = games[c].runGameWeighted();
+            double jack = (o.step == 5) ? o.weight : 0.0;
+            a.sumW += o.weight;
+            a.sumW2 += o.weight * o.weight;
+            a.sumWJack += jack;
+            a.sumWJack2 += jack * jack;
+            a.sumWProfit += o.weight * o.profit;
+            if (o.step == 5) a.jackHits++;
+        }
+    });
+    Acc total;
+    for (const auto& a : accs) {
+        total.sumW += a.sumW;
+        total.sumW2 += a.sumW2;
+        total.sumWJack += a.sumWJack;
+        total.sumWJack2 += a.sumWJack2;
+        total.sumWProfit += a.sumWProfit;
+        total.jackHits += a.jackHits;
+    }
+    double n = static_cast<double>(std::max<size_t>(1, numGames));
+    // unbiased IS estimates: mean of w * f under the proposal
+    double jackpotProb = total.sumWJack / n;
+    double jackpotStdErr = std::sqrt(std::max(0.0, total.sumWJack2 / n - jackpotProb * jackpotProb) / n);
+    double ev = total.sumWProfit / n;
+    // Kish effective sample size of the importance weights
+    double ess = total.sumW2 > 0 ? total.sumW * total.sumW / total.sumW2 : 0.0;
+    int maxPayout = params.at("payoutPerStep5P");
+    std::cout << "Importance sampling (bias=" << bias << ", games=" << numGames << ")" << std::endl;
+    std::cout << "Jackpot hits=" << total.jackHits
+              << ", P(step 5)=" << jackpotProb << " +/- " << jackpotStdErr << std::endl;
+    std::cout << "EV=" << ev << ", max-payout exposure per game=" << jackpotProb * maxPayout
+              << " (payout " << maxPayout << ")" << std::endl;
+    // plain MC games giving the same P(step 5) variance: n * p(1-p) / Var_q[w * 1{step 5}]
+    double varIS = total.sumWJack2 / n - jackpotProb * jackpotProb;
+    double plainEquivalent = varIS > 0 ? n * jackpotProb * (1.0 - jackpotProb) / varIS : 0.0;
+    std::cout << "Mean weight=" << total.sumW / n << ", effective sample size=" << ess << std::endl;
+    std::cout << "Equivalent plain-MC games for P(step 5)=" << plainEquivalent
+              << " (" << plainEquivalent / n << "x)" << std::endl;
+    return true;
+}
+
+std::string Simulation::applyParamOverride(std::map<std::string,int>& p, const std::string& token) {
+    auto pos = token.find('=');
+    if (pos == std::string::npos) return "malformed token '" + token + "'";
+    std::string k = token.substr(0, pos);
+    if (p.find(k) == p.end()) return "unknown parameter '" + k + "'";
+    std::string v = token.substr(pos + 1);
+    try {
+        size_t used = 0;
+        int val = std::stoi(v, &used);
+        if (used != v.size()) return "bad value for '" + k + "'";
+        p[k] = val;
+    } catch (const std::exception&) {
+        return "bad value for '" + k + "'";
+    }
+    return "";
+}
+
+std::string Simulation::validateParams(const std::map<std::string,int>& p) {
+    if (p.at("numOfDiceP") < 1 || p.at("numOfDiceP") > 10) return "numOfDiceP must be in [1,10]";
+    if (p.at("maxRolls") < 1) return "maxRolls must be positive";
+    return "";
+}
+
+Simulation::QueryResult Simulation::evaluateQuery(const std::map<std::string,int>& p, bool& cached) {
+    // canonical key over the full parameter set
+    std::string key;
+    for (const auto& kv : p) key += kv.first + "=" + std::to_string(kv.second) + ";";
+    auto it = queryCache.find(key);
+    if (it != queryCache.end()) {
+        cached = true;
+        return it->second;
+    }
+    cached = false;
+    QueryResult res{};
+    computeFiniteHorizonOutcome(p, res.ev, res.winRate);
+    res.theoEV = computeTheoreticalEV(p);
+    // stop growing once full; concurrent_unordered_map has no safe concurrent erase
+    if (queryCache.size() < maxQueryCacheEntries) queryCache.insert({key, res});
+    return res;
+}
+
+bool Simulation::handleServiceLine(const std::string& line, std::map<std::string,int>& base, std::string& reply) {
+    // parse "key=value ..." overrides on top of a parameter set
+    auto applyOverrides = [&](std::istringstream& iss, std::map<std::string,int>& p) -> std::string {
+        std::string tok;
+        while (iss >> tok) {
+            std::string err = applyParamOverride(p, tok);
+            if (!err.empty()) return "error " + err;
+        }
+        std::string err = validateParams(p);
+        if (!err.empty()) return "error " + err;
+        if (p.at("maxRolls") > maxServiceRolls) {
+            return "error maxRolls must be in [1," + std::to_string(maxServiceRolls) + "]";
+        }
+        return "";
+    };
+    auto formatResult = [](const QueryResult& r, bool cached) {
+        std::ostringstream oss;
+        oss << "ev=" << r.ev << " winRate=" << r.winRate
+            << " theoEV=" << r.theoEV << " cached=" << cached;
+        return oss.str();
+    };
+
+    std::istringstream iss(line);
+    std::string cmd;
+    if (!(iss >> cmd)) { reply.clear(); return true; }  // blank line: no reply
+    if (cmd == "quit") return false;
+    if (cmd == "params") {
+        std::ostringstream oss;
+        for (const auto& kv : base) oss << kv.first << "=" << kv.second << " ";
+        reply = oss.str();
+        return true;
+    }
+    if (cmd == "base") {
+        auto next = base;
+        std::string err = applyOverrides(iss, next);
+        if (err.empty()) base = std::move(next);
+        reply = err.empty() ? "ok" : err;
+        return true;
+    }
+    // query: one or more ';'-separated override sets, evaluated in parallel
+    std::vector<std::string> sets;
+    std::istringstream all(line);
+    for (std::string part; std::getline(all, part, ';');) sets.push_back(part);
+    std::vector<std::string> replies(sets.size());
+    auto answer = [&](size_t i) {
+        auto p = base;
+        std::istringstream setStream(sets[i]);
+        std::string err = applyOverrides(setStream, p);
+        if (!err.empty()) { replies[i] = err; return; }
+        bool cached = false;
+        QueryResult r = evaluateQuery(p, cached);
+        replies[i] = formatResult(r, cached);
+    };
+    if (sets.size() == 1) answer(0);
+    else tbb::parallel_for(size_t(0), sets.size(), answer);
+    reply.clear();
+    for (size_t i = 0; i < replies.size(); ++i) {
+        if (i > 0) reply += "\n";
+        reply += replies[i];
+    }
+    return true;
+}
+
+void Simulation::serveStream(std::istream& in, std::ostream& out) {
+    auto base = params;
+    std::string line, reply;
+    while (std::getline(in, line)) {
+        if (!handleServiceLine(line, base, reply)) break;
+        if (!reply.empty()) out << reply << std::endl;
+    }
+}
+
+void Simulation::serveConnection(int fd) {
+    // each client gets its own base parameter set
+    auto base = params;
+    std::string pending, reply;
+    char buf[4096];
+    auto rejectLongLine = [fd, &buf] {
+        static const std::string msg = "error line too long\n";
+        (void)!write(fd, msg.data(), msg.size());
+        // closing with unread input resets the connection and loses the reply,
+        // so half-close and discard a bounded amount of what is left first
+        shutdown(fd, SHUT_WR);
+        timeval timeout{1, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        size_t drained = 0;
+        ssize_t n;
+        while (drained < (1u << 20) && (n = read(fd, buf, sizeof(buf))) > 0) drained += static_cast<size_t>(n);
+    };
+    while (true) {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n <= 0) break;
+        pending.append(buf, static_cast<size_t>(n));
+        size_t pos;
+        while ((pos = pending.find('\n')) != std::string::npos) {
+            if (pos > maxServiceLineBytes) { rejectLongLine(); return; }
+            std::string line = pending.substr(0, pos);
+            pending.erase(0, pos + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!handleServiceLine(line, base, reply)) return;
+            if (reply.empty()) continue;
+            reply += "\n";
+            if (write(fd, reply.data(), reply.size()) < 0) return;
+        }
+        // a client that never sends a newline must not grow pending without bound
+        if (pending.size() > maxServiceLineBytes) { rejectLongLine(); return; }
+    }
+}
+
+// write end of the self-pipe that wakes serve's accept loop on SIGINT/SIGTERM
+static int serviceStopFd = -1;
+
+static void requestServiceStop(int) {
+    char byte = 1;
+    if (serviceStopFd >= 0) (void)!write(serviceStopFd, &byte, 1);
+}
+
+void Simulation::serve(const std::string& socketPath) {
+    // throttle TBB to user-specified threads
+    tbb::global_control ctl(tbb::global_control::max_allowed_parallelism, static_cast<int>(threadCount));
+    // warm the dice distribution and cache with the starting parameters
+    bool cached = false;
+    evaluateQuery(params, cached);
+    if (socketPath.empty()) {
+        serveStream(std::cin, std::cout);
+        return;
+    }
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "Error: could not create socket" << std::endl;
+        return;
+    }
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Error: socket path too long" << std::endl;
+        close(listenFd);
+        return;
+    }
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(listenFd, 16) < 0) {
+        std::cerr << "Error: could not listen on " << socketPath << std::endl;
+        close(listenFd);
+        return;
+    }
+    // a client hanging up mid-reply must not kill the service
+    std::signal(SIGPIPE, SIG_IGN);
+    // SIGINT/SIGTERM stop the accept loop so clients are joined and the socket removed
+    int stopPipe[2];
+    if (pipe(stopPipe) < 0) {
+        std::cerr << "Error: could not create stop pipe" << std::endl;
+        close(listenFd);
+        unlink(socketPath.c_str());
+        return;
+    }
+    serviceStopFd = stopPipe[1];
+    struct sigaction stopAction{};
+    stopAction.sa_handler = requestServiceStop;
+    sigemptyset(&stopAction.sa_mask);
+    struct sigaction oldInt{}, oldTerm{};
+    sigaction(SIGINT, &stopAction, &oldInt);
+    sigaction(SIGTERM, &stopAction, &oldTerm);
+    std::cout << "Serving EV queries on " << socketPath << std::endl;
+    // client threads are owned here and joined before serve returns
+    struct Client { std::thread worker; int fd; std::atomic<bool> done{false}; };
+    std::list<Client> clients;
+    std::mutex clientsMutex;  // guards fd close vs. shutdown below
+    auto reap = [&] {
+        for (auto it = clients.begin(); it != clients.end();) {
+            if (it->done) { it->worker.join(); it = clients.erase(it); }
+            else ++it;
+        }
+    };
+    while (true) {
+        pollfd fds[2] = {{listenFd, POLLIN, 0}, {stopPipe[0], POLLIN, 0}};
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents & POLLIN) break;  // stop requested
+        int clientFd = accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        reap();
+        // blocking client I/O stays off the TBB workers; batches still use the pool
+        Client& c = clients.emplace_back();
+        c.fd = clientFd;
+        c.worker = std::thread([this, &c, &clientsMutex] {
+            serveConnection(c.fd);
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            close(c.fd);
+            c.fd = -1;
+            c.done = true;
+        });
+    }
+    close(listenFd);
+    unlink(socketPath.c_str());
+    // wake clients blocked in read, then wait for them to finish
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        for (auto& c : clients) if (c.fd >= 0) shutdown(c.fd, SHUT_RDWR);
+    }
+    for (auto& c : clients) c.worker.join();
+    sigaction(SIGINT, &oldInt, nullptr);
+    sigaction(SIGTERM, &oldTerm, nullptr);
+    serviceStopFd = -1;
+    close(stopPipe[0]);
+    close(stopPipe[1]);
+    std::cout << "EV query service stopped" << std::endl;
+}
+
+bool Simulation::applyMove(std::map<std::string,int>& p, const std::string& key, int delta) const {
+    int oldVal = p.at(key);
+    int val = oldVal + delta;
+    const auto& rg = bounds.at(key);
+    if (val < rg.first || val > rg.second) return false;
+    p[key] = val;
+    // enforce monotonic yard thresholds
+    if (key.rfind("yardsPerStep", 0) == 0) {
+        if (!(p["yardsPerStep1P"] < p["yardsPerStep2P"] &&
+              p["yardsPerStep2P"] < p["yardsPerStep3P"] &&
+              p["yardsPerStep3P"] < p["yardsPerStep4P"])) {
+            p[key] = oldVal;
+            return false;
+        }
+    }
+    // enforce monotonic payout per step
+    if (key.rfind("payoutPerStep", 0) == 0) {
+        if (!(p["payoutPerStep1P"] < p["payoutPerStep2P"] &&
+              p["payoutPerStep2P"] < p["payoutPerStep3P"] &&
+              p["payoutPerStep3P"] < p["payoutPerStep4P"] &&
+              p["payoutPerStep4P"] < p["payoutPerStep5P"])) {
+            p[key] = oldVal;
+            return false;
+        }
+    }
+    return true;
+}
+
+void Simulation::reportFinalParams(double finalAvgProfit, double finalWinRate) const {
     double finalTheoEV = computeTheoreticalEV(params);
     std::cout << "Optimization complete. Final avgProfit=" << finalAvgProfit
               << ", theoreticalEV=" << finalTheoEV << std::endl;
@@ -216,19 +635,10 @@ void Simulation::run(size_t numOfRuns) {
     }
 }
 
-// compute theoretical EV given parameters (analytical outcome-tree)
-double Simulation::computeTheoreticalEV(const std::map<std::string,int>& p) const {
-    int D = p.at("numOfDiceP");
+// probability of each dice sum for D dice, computed once per thread
+const std::vector<double>& Simulation::sumDistribution(int D) const {
     int minSum = D, maxSum = D * 6;
-    double r = p.at("noWinRangeP");
-    double mid = (minSum + maxSum) / 2.0;
-    int failMin = std::max(minSum, (int)std::ceil(mid - r));
-    int failMax = std::min(maxSum, (int)std::floor(mid + r));
-    int maxRolls = p.at("maxRolls");
-    double payIn = p.at("payIn");
-    // compute sum distribution once
     static thread_local std::map<int, std::vector<double>> cache;
-    std::vector<double> sumProb;
     auto itC = cache.find(D);
     if (itC == cache.end()) {
         // build raw distribution
@@ -240,14 +650,25 @@ double Simulation::computeTheoreticalEV(const std::map<std::string,int>& p) cons
             dist.swap(next);
         }
         double total = std::accumulate(dist.begin(), dist.end(), 0.0);
-        sumProb.assign(maxSum+1, 0.0);
-        for (int s = minSum; s <= maxSum; s++) sumProb[s] = dist[s] / total;
-        cache[D] = sumProb;
-    } else {
-        sumProb = itC->second;
+        std::vector<double> probs(maxSum+1, 0.0);
+        for (int s = minSum; s <= maxSum; s++) probs[s] = dist[s] / total;
+        itC = cache.emplace(D, std::move(probs)).first;
     }
+    return itC->second;
+}
+
+// build transition matrix and optimal-stopping values for given parameters
+void Simulation::solveTheoreticalChain(const std::map<std::string,int>& p,
+                                       std::array<std::array<double,6>,6>& T,
+                                       std::array<double,6>& V) const {
+    int D = p.at("numOfDiceP");
+    int minSum = D, maxSum = D * 6;
+    double r = p.at("noWinRangeP");
+    double mid = (minSum + maxSum) / 2.0;
+    int failMin = std::max(minSum, (int)std::ceil(mid - r));
+    int failMax = std::min(maxSum, (int)std::floor(mid + r));
+    const std::vector<double>& sumProb = sumDistribution(D);
     // build transition matrix T[s][s']
-    std::array<std::array<double,6>,6> T{};
     for (int s = 0; s <= 5; s++) for (int sp = 0; sp <= 5; sp++) T[s][sp] = 0.0;
     for (int s = 0; s <= 5; s++) {
         for (int sum = minSum; sum <= maxSum; sum++) {
@@ -262,7 +683,6 @@ double Simulation::computeTheoreticalEV(const std::map<std::string,int>& p) cons
         }
     }
     // value iteration
-    std::array<double,6> V;
     for (int s = 0; s <= 5; s++) {
         V[s] = (s > 0 && s <=5) ? p.at("payoutPerStep"+std::to_string(s)+"P") : 0.0;
     }
@@ -276,7 +696,96 @@ double Simulation::computeTheoreticalEV(const std::map<std::string,int>& p) cons
         }
         V = Vnew;
     }
-    return V[0] - payIn;
+}
+
+// compute theoretical EV given parameters (analytical outcome-tree)
+double Simulation::computeTheoreticalEV(const std::map<std::string,int>& p) const {
+    std::array<std::array<double,6>,6> T;
+    std::array<double,6> V;
+    solveTheoreticalChain(p, T, V);
+    return V[0] - p.at("payIn");
+}
+
+// compute EV and probability of a positive profit under the optimal-stopping
+// policy, playing out the finite roll budget the same way RazzleGame::runGame does
+void Simulation::computeFiniteHorizonOutcome(const std::map<std::string,int>& p, double& ev, double& winRate) const {
+    std::array<std::array<double,6>,6> T;
+    std::array<double,6> V;
+    solveTheoreticalChain(p, T, V);
+    std::array<double,6> payout{};
+    std::array<bool,6> policy{};
+    for (int s = 1; s <= 5; s++) payout[s] = p.at("payoutPerStep"+std::to_string(s)+"P");
+    for (int s = 0; s < 5; s++) {
+        double cont = 0.0;
+        for (int sp = 0; sp <= 5; sp++) cont += T[s][sp] * V[sp];
+        policy[s] = cont > payout[s];
+    }
+    // game transition, matching RazzleGame::nextStep: the no-score band only
+    // blocks a step++, the step still becomes max(s, yard(sum))
+    int D = p.at("numOfDiceP");
+    const std::vector<double>& sumProb = sumDistribution(D);
+    std::array<std::array<double,6>,6> F{};
+    for (int s = 0; s <= 5; s++) {
+        for (int sum = D; sum <= D * 6; sum++) {
+            int yard = (sum <= p.at("yardsPerStep1P")) ? 1
+                     : (sum <= p.at("yardsPerStep2P")) ? 2
+                     : (sum <= p.at("yardsPerStep3P")) ? 3
+                     : (sum <= p.at("yardsPerStep4P")) ? 4 : 5;
+            F[s][std::max(s, yard)] += sumProb[sum];
+        }
+    }
+    double payIn = p.at("payIn");
+    // forward pass over the step distribution of games still rolling
+    std::array<double,6> alive{};
+    alive[0] = 1.0;
+    ev = 0.0;
+    winRate = 0.0;
+    for (int rollsLeft = p.at("maxRolls") - 1; rollsLeft >= 0; rollsLeft--) {
+        std::array<double,6> next{};
+        for (int s = 0; s <= 5; s++) for (int sp = 0; sp <= 5; sp++) next[sp] += alive[s] * F[s][sp];
+        for (int s = 0; s <= 5; s++) {
+            if (policy[s] && rollsLeft > 0) continue;
+            // stopped: out of rolls short of the last step pays nothing
+            double paid = (rollsLeft == 0 && s < 5) ? 0.0 : payout[s];
+            ev += next[s] * (paid - payIn);
+            if (paid - payIn > 0) winRate += next[s];
+            next[s] = 0.0;
+        }
+        alive = next;
+        // every game has stopped: remaining rolls cannot change the outcome
+        if (std::accumulate(alive.begin(), alive.end(), 0.0) < 1e-15) break;
+    }
+}
+
+// compare the finite-horizon analytics against RazzleGame::runGame sampling
+// across no-score band widths
+void Simulation::checkFiniteHorizon(size_t numGames) {
+    // parameters that move the outcome under runGame's step rule
+    // (the no-score band only blocks step++, so it does not)
+    const std::vector<std::pair<std::string,int>> sweep = {
+        {"yardsPerStep4P", 16}, {"yardsPerStep4P", 17}, {"yardsPerStep4P", 18},
+        {"yardsPerStep3P", 10}, {"yardsPerStep3P", 13},
+        {"maxRolls", 2}, {"maxRolls", 3}, {"maxRolls", 8},
+        {"payoutPerStep4P", 3}, {"payoutPerStep4P", 9}, {"payIn", 2},
+    };
+    std::cout << "override  analytic ev/winRate  sampled ev/winRate" << std::endl;
+    for (const auto& [key, val] : sweep) {
+        auto p = params;
+        p[key] = val;
+        double ev = 0.0, winRate = 0.0;
+        computeFiniteHorizonOutcome(p, ev, winRate);
+        RazzleGame game(p, rd);
+        double profitSum = 0.0;
+        size_t wins = 0;
+        for (size_t i = 0; i < numGames; ++i) {
+            int profit = game.runGame();
+            profitSum += profit;
+            if (profit > 0) wins++;
+        }
+        double n = static_cast<double>(std::max<size_t>(1, numGames));
+        std::cout << key << "=" << val << "  " << ev << " / " << winRate
+                  << "  " << profitSum / n << " / " << wins / n << std::endl;
+    }
 }
 
 int main(int argc, char* argv[]) {
@@ -300,9 +809,52 @@ int main(int argc, char* argv[]) {
     size_t totalRuns = 50000;
     if (argc > 1) totalRuns = std::stoul(argv[1]);
     size_t threads = std::thread::hardware_concurrency();
+    std::string mode = argc > 2 ? argv[2] : "anneal";
+
+    // tail mode: optional bias followed by key=value parameter overrides
+    double tailBias = 80.0;
+    if (mode == "tail") {
+        for (int i = 3; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg.find('=') != std::string::npos) {
+                std::string err = Simulation::applyParamOverride(initialParams, arg);
+                if (!err.empty()) {
+                    std::cerr << "Error: " << err << std::endl;
+                    return 1;
+                }
+                continue;
+            }
+            size_t used = 0;
+            try {
+                tailBias = std::stod(arg, &used);
+            } catch (const std::exception&) {
+                used = 0;
+            }
+            if (used == 0 || used != arg.size()) {
+                std::cerr << "Error: bad argument '" << arg << "'" << std::endl;
+                return 1;
+            }
+        }
+        std::string err = Simulation::validateParams(initialParams);
+        if (!err.empty()) {
+            std::cerr << "Error: " << err << std::endl;
+            return 1;
+        }
+    }
 
     Simulation sim(initialParams, threads);
-    sim.run(totalRuns);
+    // optional mode: "steepest [seed]" for full-neighborhood descent,
+    // "tail [bias] [key=value ...]" for importance-sampled jackpot estimates,
+    // "serve [socket]" for the EV query service, "check" to compare its
+    // analytics against sampled games, default annealing
+    if (mode == "steepest") {
+        if (argc > 3) sim.runSteepestDescent(50, static_cast<unsigned>(std::stoul(argv[3])));
+        else sim.runSteepestDescent();
+    }
+    else if (mode == "serve") sim.serve(argc > 3 ? argv[3] : "");
+    else if (mode == "check") sim.checkFiniteHorizon(totalRuns);
+    else if (mode == "tail") return sim.estimateTailRisk(totalRuns, tailBias) ? 0 : 1;
+    else sim.run(totalRuns);
     return 0;
 }
 
@@ -312,4 +864,8 @@ g++ -std=c++17 game.cpp monteCarlo.cpp \
     -L$(brew --prefix tbb)/lib -ltbb \
     -pthread -O2 -o rc_opt
 */
-// ./rc_opt
\ No newline at end of file
+// ./rc_opt
+// ./rc_opt 0 steepest [seed]
+// ./rc_opt 100000 tail 80 yardsPerStep4P=17
+// ./rc_opt 0 serve [/tmp/razzle.sock]
+// ./rc_opt 2000000 check
\ No newline at end of file
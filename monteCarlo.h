@@ -4,6 +4,9 @@
 #include <map>
 #include <string>
 #include <cstddef>
+#include <istream>
+#include <ostream>
+#include <tbb/concurrent_unordered_map.h>
 
 class Simulation {
 public:
@@ -17,12 +20,60 @@ public:
     // run discrete gradient descent for numOfRuns per evaluation
     void run(size_t numOfRuns);
 
+    // deterministic steepest descent: score the full (key, delta) neighborhood
+    // each step in parallel, with seeded perturbation restarts at local optima
+    void runSteepestDescent(size_t maxRestarts = 50, unsigned seed = 12345);
+
+    // importance-sampled Monte Carlo for rare top-step outcomes: estimates
+    // jackpot frequency, EV and max-payout exposure with effective sample size;
+    // false if the bias is invalid
+    bool estimateTailRisk(size_t numGames, double bias = 80.0);
+
+    // apply one "key=value" override; returns an error message or ""
+    static std::string applyParamOverride(std::map<std::string, int>& p, const std::string& token);
+    // sanity-check a parameter set before building a game from it
+    static std::string validateParams(const std::map<std::string, int>& p);
+
+    // long-lived EV query service: line protocol on stdin/stdout, or on a
+    // Unix domain socket when a path is given
+    void serve(const std::string& socketPath = "");
+
+    // compare served EV / win rate against runGame sampling over a parameter sweep
+    void checkFiniteHorizon(size_t numGames);
+
 private:
     std::map<std::string, int> params;
     size_t threadCount;
     std::random_device rd;
     // bounds for each parameter [min, max]
     std::map<std::string, std::pair<int,int>> bounds;
+    // analytical results per parameter set, shared by all service clients
+    struct QueryResult { double ev, winRate, theoEV; };
+    // bounds the forward pass so a single query stays in the microsecond range
+    static constexpr int maxServiceRolls = 1000;
+    // upper bound on cached parameter sets in a long-running service
+    static constexpr size_t maxQueryCacheEntries = 1 << 16;
+    // longest protocol line a socket client may send before being dropped
+    static constexpr size_t maxServiceLineBytes = 8192;
+    tbb::concurrent_unordered_map<std::string, QueryResult> queryCache;
     // compute analytical expected value (theoretical EV) for given params
     double computeTheoreticalEV(const std::map<std::string,int>& p) const;
+    // analytical EV and win rate (P(profit > 0)) over the finite roll budget
+    void computeFiniteHorizonOutcome(const std::map<std::string,int>& p, double& ev, double& winRate) const;
+    // dice-sum probabilities indexed by sum, cached per thread
+    const std::vector<double>& sumDistribution(int D) const;
+    // shared transition matrix / value iteration behind the analytical metrics
+    void solveTheoreticalChain(const std::map<std::string,int>& p,
+                               std::array<std::array<double,6>,6>& T,
+                               std::array<double,6>& V) const;
+    // apply delta to key within bounds and monotonic constraints; false if rejected
+    bool applyMove(std::map<std::string,int>& p, const std::string& key, int delta) const;
+    // print final parameters and write them to final_params.txt
+    void reportFinalParams(double finalAvgProfit, double finalWinRate) const;
+    // service helpers: answer one parameter set (cached), one protocol line,
+    // and one client stream
+    QueryResult evaluateQuery(const std::map<std::string,int>& p, bool& cached);
+    bool handleServiceLine(const std::string& line, std::map<std::string,int>& base, std::string& reply);
+    void serveStream(std::istream& in, std::ostream& out);
+    void serveConnection(int fd);
 };
\ No newline at end of file